@@ -0,0 +1,142 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifBatchCorrector.h
+**
+** Parallel batch CIF corrector class.
+*/
+
+
+#ifndef CIFBATCHCORRECTOR_H
+#define CIFBATCHCORRECTOR_H
+
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "DataInfo.h"
+#include "DicFile.h"
+#include "CifFile.h"
+#include "CifEnumIndex.h"
+
+
+/**
+**  \class CifBatchCorrector
+**
+**  \brief Corrects a list of CIF files on a pool of worker threads.
+**
+**  The dictionaries and the configuration file are loaded once by the
+**  caller and shared, read-only, by all workers, together with one
+**  enumeration index. Each input file is parsed, corrected and written to
+**  a file named by CifCorrector::MakeOutputCifFileName(). Files are
+**  initially dealt to the workers largest first, and idle workers steal
+**  files from the busiest ones. The number of files that are resident in
+**  memory at the same time is bounded.
+**
+**  The CIF parser can parse only one file at a time in a process, so with
+**  worker threads alone, parsing is serialized and the speedup is limited
+**  by the share of time spent parsing. For parsing to scale, the files are
+**  divided among worker processes (see SetNumProcesses()), each with its
+**  own pool of worker threads. Worker processes are forked after all the
+**  dictionary tables are read (see SetDictFiles()), and share them
+**  copy-on-write.
+**
+**  In patch output mode, files that need no correction are not written,
+**  and only the changed categories of the other files are written again.
+**  In dry run mode, no file is written, and the files that need
+**  correction are reported. In streamed output mode, each file is
+**  corrected and written by CifStreamCorrector, with bounded memory. As it
+**  parses the file one category at a time, a process corrects only one
+**  streamed file at a time.
+*/
+class CifBatchCorrector
+{
+  public:
+    enum eOutputMode
+    {
+        eWRITE = 0,
+        eWRITE_PATCH,
+        eDRY_RUN,
+        eWRITE_STREAMED
+    };
+
+    struct Stats
+    {
+        unsigned int numFiles;
+        unsigned int numFailed;
+        unsigned int numChanged;
+        unsigned long long numBytes;
+        double elapsedSecs;
+
+        double FilesPerSec() const;
+        double MBytesPerSec() const;
+    };
+
+    static void ReadManifest(std::vector<std::string>& fileNames,
+      const std::string& manifestFileName);
+
+    CifBatchCorrector(DataInfo& dataInfo, DataInfo& pdbxDataInfo,
+      CifFile& configFile, const unsigned int numThreads = 0,
+      const unsigned int maxInFlight = 0, const bool verbose = false);
+    ~CifBatchCorrector();
+
+    void SetOutputMode(const eOutputMode outputMode);
+
+    /**
+    **  Sets the number of worker processes, one by default. Each process
+    **  runs the number of worker threads given to the constructor. Must not
+    **  be more than one if the caller has other threads running, as they
+    **  are not copied into the worker processes.
+    */
+    void SetNumProcesses(const unsigned int numProcesses);
+
+    /**
+    **  Sets the dictionary files of the DataInfo objects given to the
+    **  constructor. Required with more than one worker process: all their
+    **  tables are read before the processes are forked (see
+    **  LoadDictTables()).
+    */
+    void SetDictFiles(DicFile& dictFile, DicFile& pdbxDictFile);
+
+    void Correct(const std::vector<std::string>& inFileNames);
+
+    const Stats& GetStats() const;
+    void WriteStats(std::ostream& outStream) const;
+
+  private:
+    DataInfo& _dataInfo;
+    DataInfo& _pdbxDataInfo;
+
+    CifFile& _configFile;
+
+    DicFile* _dictFileP;
+    DicFile* _pdbxDictFileP;
+
+    CifEnumIndex _enumIndex;
+
+    unsigned int _numThreads;
+    unsigned int _maxInFlight;
+    unsigned int _numProcesses;
+
+    bool _verbose;
+
+    eOutputMode _outputMode;
+
+    Stats _stats;
+
+    void CorrectInProcesses(const std::vector<std::string>& inFileNames,
+      const std::vector<unsigned long long>& fileSizes,
+      const std::vector<unsigned int>& order);
+    void CorrectInThreads(const std::vector<std::string>& inFileNames,
+      const std::vector<unsigned long long>& fileSizes,
+      const std::vector<unsigned int>& order);
+    bool CorrectFile(bool& changed, const std::string& inFileName);
+};
+
+
+#endif
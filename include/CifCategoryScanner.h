@@ -0,0 +1,110 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifCategoryScanner.h
+**
+** CIF category scanner class.
+*/
+
+
+#ifndef CIFCATEGORYSCANNER_H
+#define CIFCATEGORYSCANNER_H
+
+
+#include <string>
+#include <vector>
+#include <set>
+#include <iostream>
+
+
+/**
+**  \class CifCategoryScanner
+**
+**  \brief Splits a CIF file into sections, one per category, without
+**  parsing the values.
+**
+**  Each section is a byte range of the file that starts at the beginning
+**  of a line. Text that does not belong to a category (block headers and
+**  comments before the first category of a block) is in sections with an
+**  empty category name. Comments between categories belong to the
+**  preceding section. The text of each section can be parsed on its own,
+**  after a block header.
+*/
+class CifCategoryScanner
+{
+  public:
+    struct Section
+    {
+        std::string blockName;
+        std::string catName;
+        unsigned long long begin;
+        unsigned long long end;
+    };
+
+    /**
+    **  Appends the text of a section to a string.
+    */
+    static void ReadSection(std::string& text, std::istream& inStream,
+      const Section& section);
+
+    CifCategoryScanner();
+    ~CifCategoryScanner();
+
+    /**
+    **  Scans a CIF file.
+    **
+    **  \param[in] fileName - the name of the file
+    **
+    **  \return true if the file has been split into sections, false if
+    **    the file cannot be opened or has constructs that cannot be split
+    **    at line boundaries (save frames, global blocks, items of
+    **    different categories on the same line).
+    */
+    bool Scan(const std::string& fileName);
+
+    const std::vector<Section>& GetSections() const;
+
+    unsigned int GetNumBlocks() const;
+
+    /**
+    **  Returns true if any category appears in more than one section of
+    **  the same block.
+    */
+    bool HasDuplicateCategories() const;
+
+  private:
+    enum eState
+    {
+        eNONE = 0,
+        eLOOP_START,
+        eLOOP_HEADER,
+        eLOOP_DATA,
+        eITEMS
+    };
+
+    std::vector<Section> _sections;
+    std::set<std::pair<std::string, std::string> > _catKeys;
+
+    unsigned int _numBlocks;
+    bool _duplicateCats;
+    bool _splittable;
+
+    eState _state;
+    std::string _blockName;
+
+    void Clear();
+    void ScanLine(const std::string& line, std::string::size_type pos,
+      const unsigned long long lineStart);
+    void ScanToken(const std::string& token, const bool firstOnLine,
+      const unsigned long long lineStart);
+    void StartSection(const bool firstOnLine,
+      const unsigned long long lineStart);
+    void SetSectionCategory(const std::string& catName);
+};
+
+
+#endif
@@ -0,0 +1,123 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifChangeJournal.h
+**
+** Journal of the changes made to a CIF file.
+*/
+
+
+#ifndef CIFCHANGEJOURNAL_H
+#define CIFCHANGEJOURNAL_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+
+
+/**
+**  \class CifChangeJournal
+**
+**  \brief Records the changes made to the data of a CIF file: updated
+**  cells, renamed items and removed items.
+**
+**  In count mode, only the number of changes and the names of the changed
+**  categories are kept, which is enough to tell if a file has been changed
+**  and which of its categories must be written again. In full mode, every
+**  change is also kept with its item, row, old value and new value. In off
+**  mode, nothing is recorded.
+*/
+class CifChangeJournal
+{
+  public:
+    enum eMode
+    {
+        eOFF = 0,
+        eCOUNT,
+        eFULL
+    };
+
+    enum eChangeType
+    {
+        eUPDATE = 0,
+        eRENAME,
+        eREMOVE
+    };
+
+    /**
+    **  A change. For eUPDATE, the value of the item in row rowIndex has
+    **  changed from oldValue to newValue. For eRENAME, oldValue and
+    **  newValue are the old and new item names. For eREMOVE, the item has
+    **  been removed, and both values are empty. Renames and removes apply
+    **  to all rows, and their rowIndex is zero.
+    */
+    struct Change
+    {
+        eChangeType type;
+        std::string item;
+        unsigned int rowIndex;
+        std::string oldValue;
+        std::string newValue;
+    };
+
+    CifChangeJournal(const eMode mode = eCOUNT);
+    ~CifChangeJournal();
+
+    void SetMode(const eMode mode);
+    eMode GetMode() const;
+
+    void Clear();
+
+    void AddUpdate(const std::string& catName, const std::string& attribName,
+      const unsigned int rowIndex, const std::string& oldValue,
+      const std::string& newValue);
+    void AddRename(const std::string& catName, const std::string& attribName,
+      const std::string& newAttribName);
+    void AddRemove(const std::string& catName,
+      const std::string& attribName);
+
+    bool IsEmpty() const;
+    unsigned long long GetNumChanges() const;
+
+    /**
+    **  Returns true if the category has been changed. Category names are
+    **  compared case-insensitively.
+    */
+    bool IsCategoryChanged(const std::string& catName) const;
+
+    /**
+    **  Gets the names of the changed categories, spelled as when they were
+    **  first changed, in case-insensitive order.
+    */
+    void GetChangedCategories(std::vector<std::string>& catNames) const;
+
+    /**
+    **  Gets the changes, in the order they were made. Empty unless in
+    **  full mode.
+    */
+    const std::vector<Change>& GetChanges() const;
+
+  private:
+    eMode _mode;
+
+    unsigned long long _numChanges;
+
+    // Names of the changed categories, by lower case name
+    std::map<std::string, std::string> _changedCats;
+    std::string _lastCatName;
+
+    std::vector<Change> _changes;
+
+    void AddCategory(const std::string& catName);
+    void AddChange(const eChangeType type, const std::string& catName,
+      const std::string& attribName, const unsigned int rowIndex,
+      const std::string& oldValue, const std::string& newValue);
+};
+
+
+#endif
@@ -8,6 +8,12 @@
 ** \file CifCorrector.h
 **
 ** CIF corrector class.
+**
+** A single dictionary, enumeration index and configuration file can be
+** shared by correctors running concurrently on different threads. Each
+** corrector must operate on its own CIF file. Dictionary lookups are
+** serialized per DataInfo object, so a dictionary file that is shared must
+** be accessed through a single DataInfo object.
 */
 
 
@@ -17,31 +23,191 @@
 
 #include <string>
 #include <vector>
+#include <map>
+#include <iostream>
 
 #include "DataInfo.h"
 #include "CifFile.h"
+#include "CifEnumIndex.h"
+#include "CifJoinIndex.h"
+#include "CifChangeJournal.h"
 
 
 class CifCorrector
 {
   public:
+    /**
+    **  Statistics of one operation, accumulated over all calls of
+    **  Correct(). There is one entry per configuration row, in
+    **  configuration order, followed by "not_applicable" and "enums".
+    **
+    **  When cell level operations share a pass over the data (the default
+    **  compiled mode), the time of the pass is divided among them in
+    **  proportion to the rows each of them scanned. In interpreted mode,
+    **  the time of each operation is measured separately.
+    */
+    struct OperStats
+    {
+        std::string oper;
+        std::string item;
+
+        double wallSecs;
+
+        unsigned long long numRowsScanned;
+        unsigned long long numCellsUpdated;
+
+        // Total size of the new values of the updated cells
+        unsigned long long numBytesUpdated;
+    };
+
     static void MakeOutputCifFileName(std::string& outCifFileName,
       const std::string& inCifFileName);
     static CifFile* CreateConfigFile();
 
     CifCorrector(CifFile& cifFile, DataInfo& dataInfo, DataInfo& pdbxDataInfo,
       CifFile& configFile, const bool verbose = false);
+    CifCorrector(CifFile& cifFile, DataInfo& dataInfo, DataInfo& pdbxDataInfo,
+      CifFile& configFile, CifEnumIndex& enumIndex,
+      const bool verbose = false);
     ~CifCorrector();
 
     void Correct();
     void CheckAliases();
 
+    /**
+    **  Selects how the configuration is executed. By default, it is
+    **  compiled into a plan that applies all value fixes of a table in a
+    **  single pass. If compiled is false, the configuration is interpreted
+    **  one row at a time, with a pass over the data for each row. Both
+    **  produce identical data.
+    */
+    void SetCompiled(const bool compiled);
+
+    /**
+    **  Gets the names of the categories that are read or changed by
+    **  operations that involve more than one table. These must be in the
+    **  CIF file at the same time when it is corrected.
+    */
+    void GetCrossTableCategories(std::vector<std::string>& catNames);
+
+    const std::vector<OperStats>& GetOperStats() const;
+
+    /**
+    **  Writes the operation statistics as a JSON object.
+    */
+    void WriteOperStats(std::ostream& outStream) const;
+    static void WriteOperStats(std::ostream& outStream,
+      const std::vector<OperStats>& operStats);
+
+    /**
+    **  Writes a string as a quoted JSON string. Quotes, backslashes and
+    **  control characters are escaped.
+    */
+    static void WriteJsonString(std::ostream& outStream,
+      const std::string& value);
+
+    /**
+    **  Gets the journal of the changes made by Correct(). By default, the
+    **  journal counts the changes and keeps the names of the changed
+    **  categories. Its mode can be set to CifChangeJournal::eFULL before
+    **  Correct(), to keep every change, or to CifChangeJournal::eOFF.
+    */
+    CifChangeJournal& GetJournal();
+
+    /**
+    **  Returns true if Correct() has changed the CIF file. Correct()
+    **  followed by IsChanged(), without writing, is a dry run that tells if
+    **  a file needs correction. Always false if the journal is off.
+    */
+    bool IsChanged() const;
+
+    /**
+    **  Writes the journal as a JSON object.
+    */
+    void WriteJournal(std::ostream& outStream) const;
+
+    /**
+    **  Writes the CIF file. A file name with the ".gz" extension gives a
+    **  gzip compressed file.
+    */
     void Write(const std::string& outFileName);
 
+    /**
+    **  Writes the CIF file as a patched copy of its source file. The text
+    **  of the categories that have not been changed, as recorded in the
+    **  journal, is copied from the source file as it is, and only the
+    **  changed categories are written again, in place. Comments that
+    **  follow a changed category are not kept.
+    **
+    **  The CIF file must have been parsed from srcFileName. If the journal
+    **  is off, or the source file is compressed, has more than one data
+    **  block or cannot be split into categories, the whole file is written
+    **  as with Write().
+    */
+    void WritePatch(const std::string& outFileName,
+      const std::string& srcFileName);
+
     static void CorrectEnumsSimple(CifFile& cifFile, DataInfo& dataInfo,
       const bool verbose = false);
+    static void CorrectEnumsSimple(CifFile& cifFile, CifEnumIndex& enumIndex,
+      const bool verbose = false);
+
+    static bool IsItemDefined(DataInfo& dataInfo, const std::string& item);
+    static void GetItemEnums(std::vector<std::string>& enums,
+      DataInfo& dataInfo, const std::string& item);
 
   private:
+    enum eOperType
+    {
+        eREMOVE = 0,
+        eRENAME,
+        eUPPER_CASE,
+        eVALUE_CHANGE,
+        eNUMERIC_LIST,
+        eMISSING_VALUES,
+        eLABELING,
+        eVALUE_CHANGE_COMPLEX
+    };
+
+    struct Oper
+    {
+        eOperType type;
+        std::string item;
+        std::string itemValue;
+        std::string refItem;
+        std::string refItemValue;
+
+        // Index of the configuration row
+        unsigned int statsIndex;
+    };
+
+    struct NoCaseLess
+    {
+        bool operator()(const std::string& a, const std::string& b) const;
+    };
+
+    // Cell level operations, in configuration order, by category name and
+    // attribute name.
+    typedef std::map<std::string, std::vector<const Oper*>, NoCaseLess>
+      AttrOpers;
+    typedef std::map<std::string, AttrOpers, NoCaseLess> CellOpers;
+
+    struct PlanStep
+    {
+        // Operation that works on whole tables or on more than one
+        // table. If not NULL, it is the only thing done in the step.
+        const Oper* operP;
+
+        // Operations that each fix one cell at a time, done in a single
+        // pass over the affected columns.
+        CellOpers cellOpers;
+
+        // If true, the pass visits all columns of all tables and, after
+        // the cell operations, fixes not applicable values and
+        // enumerations.
+        bool allColumns;
+    };
+
     CifFile& _cifFile;
 
     DataInfo& _dataInfo;
@@ -49,11 +215,42 @@ class CifCorrector
 
     CifFile& _configFile;
 
+    CifEnumIndex* _enumIndexP;
+    CifEnumIndex* _ownEnumIndexP;
+
     bool _verbose;
 
     ISTable* _configTableP;
 
+    std::string _configTableName;
+    std::vector<std::vector<std::string> > _configRows;
+
+    bool _compiled;
+    std::vector<Oper> _opers;
+    std::vector<PlanStep> _plan;
+
+    std::vector<OperStats> _operStats;
+    OperStats* _currStatsP;
+
+    CifChangeJournal _journal;
+
+    void Init();
     void ValidateConfigTable();
+    void CompilePlan();
+
+    void Interpret();
+    void ExecutePlan();
+    void ExecuteOper(const Oper& oper);
+    void ExecuteCellPass(const PlanStep& step);
+    void FixCell(std::string& value, std::string& workValue,
+      const std::vector<const Oper*>& opers);
+    void LogChange(const std::string& item, const std::string& fromValue,
+      const std::string& toValue);
+
+    void CountRows(const unsigned int numRows);
+    void UpdateCell(ISTable& catTable, const unsigned int rowIndex,
+      const std::string& attribName, const std::string& value);
+    static void CountUpdate(OperStats* operStatsP, const std::string& value);
 
     void RemoveItem(const std::string& item);
     void CorrectUpperCase(const std::string& item);
@@ -61,6 +258,8 @@ class CifCorrector
     void CorrectValues(const std::string& item, const std::string& itemValue,
       const std::string& refItemValue);
     void CorrectEnums();
+    static void FixEnums(CifFile& cifFile, CifEnumIndex& enumIndex,
+      const bool verbose, OperStats* operStatsP, CifChangeJournal* journalP);
     void CorrectNumericList(const std::string& item);
     void CorrectNotApplicableValues();
     void CorrectMissingValues(const std::string& item,
@@ -70,8 +269,6 @@ class CifCorrector
     void CorrectBadSequence(const std::string& item,
       const std::string& refCondItem, const std::string& refCondItemValue);
 
-    static unsigned int FindEnumIndex(const std::string& value,
-      const std::vector<std::string>& enums);
     void FixNumericList(std::string& outValue, const std::string& inValue);
     void FixNotApplicable(std::string& outValue, const std::string& inValue);
     void FixBadSequence(std::vector<std::string>& outValues,
@@ -88,7 +285,8 @@ class CifCorrector
     void GetRefValues(std::vector<std::string>& refValues,
       const std::vector<std::string>& srcItems,
       const std::vector<std::string>& srcValues,
-      const std::vector<std::string>& refItems, Block& block);
+      const std::vector<std::string>& refItems, Block& block,
+      CifJoinIndex& joinIndex);
     void GetTableValues(vector<string>& values, const vector<string>& items,
       Block& block, const unsigned int rowIndex);
 
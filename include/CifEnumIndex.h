@@ -0,0 +1,94 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifEnumIndex.h
+**
+** Dictionary enumeration index class.
+*/
+
+
+#ifndef CIFENUMINDEX_H
+#define CIFENUMINDEX_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "DataInfo.h"
+
+
+/**
+**  \class CifEnumIndex
+**
+**  \brief Index of the enumerations of dictionary items, used to correct
+**  the casing and spacing of enumerated values.
+**
+**  For every item, enumerations are stored both in their canonical
+**  spelling and in normalized form (no white space, lower case). An item
+**  is indexed the first time it is looked up and is kept for the lifetime
+**  of the index, so one index should be created per dictionary and reused
+**  for all files. Lookups are safe to do from multiple threads.
+*/
+class CifEnumIndex
+{
+  public:
+    class ItemEnums
+    {
+      public:
+        ItemEnums(const std::vector<std::string>& enums);
+
+        /**
+        **  Finds the canonical enumeration that matches a value.
+        **
+        **  \param[in] value - the value to be matched
+        **  \param[in] normValue - working buffer for the normalized value,
+        **    reused across calls to avoid reallocation
+        **
+        **  \return pointer to the canonical enumeration, or NULL if the
+        **    value does not match any enumeration. If the value is
+        **    already canonical, no normalization is done.
+        */
+        const std::string* Find(const std::string& value,
+          std::string& normValue) const;
+
+      private:
+        std::vector<std::string> _enums;
+        std::unordered_set<std::string> _canonEnums;
+        std::unordered_map<std::string, unsigned int> _normEnums;
+    };
+
+    static void Normalize(std::string& normValue, const std::string& value);
+
+    CifEnumIndex(DataInfo& dataInfo);
+    CifEnumIndex(DataInfo& dataInfo, DataInfo& fallbackDataInfo);
+    ~CifEnumIndex();
+
+    /**
+    **  Returns the enumerations of an item, or NULL if the item does not
+    **  have enumerations defined. Enumerations are taken from the primary
+    **  dictionary, and from the fallback dictionary if the primary
+    **  dictionary does not define any.
+    */
+    const ItemEnums* GetItemEnums(const std::string& item);
+
+  private:
+    DataInfo& _dataInfo;
+    DataInfo* _fallbackDataInfoP;
+
+    std::mutex _mutex;
+    std::map<std::string, ItemEnums*> _itemEnums;
+
+    CifEnumIndex(const CifEnumIndex&);
+    CifEnumIndex& operator=(const CifEnumIndex&);
+};
+
+
+#endif
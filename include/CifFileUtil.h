@@ -9,15 +9,46 @@
 
 
 #include <string>
+#include <iostream>
 
 #include "CifFileReadDef.h"
 #include "DicFile.h"
 #include "CifFile.h"
+#include "CifEnumIndex.h"
 
 
+/**
+**  Gets a dictionary, either from the dictionary text file or from the
+**  dictionary SDB file.
+**
+**  A dictionary text file in READ_MODE is cached only if \e dictCacheDirName
+**  is specified. The first load writes the parsed and post-processed
+**  dictionary to an SDB file in the cache directory, and later loads open
+**  that file read-only instead of parsing the text. The cache file name is
+**  derived from the path, size, modification time and content of the
+**  dictionary and DDL files, so a changed dictionary is never read from a
+**  stale cache file. The DDL file is the source file of \e ddlFileP or,
+**  for a DDL read from an SDB file, \e ddlSdbFileName. If neither is
+**  known, the cache is not used.
+**
+**  A dictionary loaded from the cache is a read-only, SDB-backed DicFile
+**  with empty parsing diagnostics. Callers that inspect the parsing
+**  diagnostics or modify the dictionary must not use the cache.
+*/
 DicFile* GetDictFile(DicFile* ddlFileP, const std::string& dictFileName,
   const std::string& dictSdbFileName = std::string(), const bool verbose =
-  false, const eFileMode fileMode = READ_MODE);
+  false, const eFileMode fileMode = READ_MODE,
+  const std::string& dictCacheDirName = std::string(),
+  const std::string& ddlSdbFileName = std::string());
+
+/**
+**  Reads all the tables of a dictionary into memory. Tables of a dictionary
+**  opened from an SDB file (including a cached one) are otherwise read on
+**  first access, through a file position that forked processes share. A
+**  dictionary must be loaded before processes that use it are forked.
+*/
+void LoadDictTables(DicFile& dictFile);
+
 void CheckDict(DicFile* dictFileP, DicFile* ddlFileP,
   const string& dictFileName, const bool extraDictChecks = false);
 void CheckCif(CifFile* cifFileP, DicFile* dictFileP,
@@ -26,6 +57,11 @@ void CheckCif(CifFile* cifFileP, DicFile* dictFileP,
 
 DicFile* ParseDict(const std::string& dictFileName, DicFile* ddlFileP = NULL,
   const bool verbose = false);
+/**
+**  Parses a CIF file. Files with the ".gz" extension are decompressed by
+**  a thread into a pipe, that the parser reads as the file. The program
+**  must link with zlib (see CifGzStream.h).
+*/
 CifFile* ParseCif(const std::string& fileName, const bool verbose = false,
   const Char::eCompareType caseSense = Char::eCASE_SENSITIVE,
   const unsigned int maxLineLength = CifFile::STD_CIF_LINE_LENGTH,
@@ -49,6 +85,26 @@ CifFile* ParseCifSelective(const std::string& fileName,
   const std::string& nullValue = CifString::UnknownValue,
   const std::string& parseLogFileName = std::string());
 
+/**
+**  Writes a CIF file to a string.
+*/
+void WriteCifString(std::string& cifString, CifFile& cifFile);
+
+/**
+**  Writes a CIF file without its block header, which is the output of
+**  WriteCifString() for a file with only an empty block of the same name.
+**  Used to write a file one category at a time.
+*/
+void WriteCifBody(std::ostream& outStream, CifFile& cifFile,
+  const std::string& header);
+
+/**
+**  Returns true if the output of a block is its header followed by the
+**  output of each of its tables written on its own, so that the output of
+**  a block can be assembled from the output of its categories.
+*/
+bool IsCifWriterSplittable();
+
 /**
 **  Corrects a CIF file with respect to the following:
 **    - Sets proper casing of the case-insensitive enumerations
@@ -66,4 +122,22 @@ CifFile* ParseCifSelective(const std::string& fileName,
 */
 void DataCorrection(CifFile& cifFile, DicFile& dicRef);
 
+/**
+**  Corrects a CIF file in the same way as DataCorrection(CifFile&, DicFile&),
+**  using a prebuilt enumeration index. The index should be created once
+**  per dictionary and reused for all files.
+**
+**  \param[in] enumIndex - reference to the enumeration index of the
+**    dictionary
+**
+**  \return None
+**
+**  \pre None
+**
+**  \post None
+**
+**  \exception: None
+*/
+void DataCorrection(CifFile& cifFile, CifEnumIndex& enumIndex);
+
 #endif
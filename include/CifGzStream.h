@@ -0,0 +1,121 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifGzStream.h
+**
+** Reading and writing of gzip compressed CIF files.
+**
+** Uses zlib. Programs that link with the module library must also link
+** with zlib (-lz), even if they do not use these functions directly, since
+** ParseCif() and CifCorrector::Write() call them for ".gz" files.
+*/
+
+
+#ifndef CIFGZSTREAM_H
+#define CIFGZSTREAM_H
+
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+
+
+struct gzFile_s;
+
+
+/**
+**  Returns true if the file name has the ".gz" extension.
+*/
+bool IsGzFileName(const std::string& fileName);
+
+/**
+**  Reads and decompresses a whole gzip compressed file into a string.
+**  Files that are not compressed are read as they are. The string is
+**  sized up front, from the size recorded in the gzip trailer or from the
+**  size of a file that is not compressed.
+**
+**  \exception NotFoundException - if the file cannot be opened
+**  \exception InvalidStateException - if the compressed data is corrupt
+*/
+void ReadGzFile(std::string& text, const std::string& fileName);
+
+/**
+**  Decompresses a gzip compressed file into another file, a buffer at a
+**  time. Files that are not compressed are copied as they are.
+**
+**  \exception NotFoundException - if either file cannot be opened
+**  \exception InvalidStateException - if the compressed data is corrupt,
+**    or the output file cannot be written
+*/
+void DecompressGzFile(const std::string& outFileName,
+  const std::string& inFileName);
+
+/**
+**  Decompresses a gzip compressed file into an open file descriptor, e.g.
+**  the write end of a pipe, a buffer at a time. The descriptor is not
+**  closed.
+**
+**  \exception NotFoundException - if the file cannot be opened
+**  \exception InvalidStateException - if the compressed data is corrupt,
+**    or the descriptor cannot be written
+*/
+void DecompressGzFile(const int outFd, const std::string& inFileName);
+
+
+/**
+**  \class CifGzStreamBuf
+**
+**  \brief Stream buffer that compresses its output into a gzip file.
+*/
+class CifGzStreamBuf : public std::streambuf
+{
+  public:
+    CifGzStreamBuf();
+    ~CifGzStreamBuf();
+
+    bool Open(const std::string& fileName);
+    bool Close();
+
+  protected:
+    virtual int_type overflow(int_type ch);
+    virtual int sync();
+
+  private:
+    gzFile_s* _gzFileP;
+    std::vector<char> _buffer;
+
+    bool FlushBuffer();
+};
+
+
+/**
+**  \class CifOutFileStream
+**
+**  \brief Output stream that writes a CIF file, gzip compressed if the
+**  file name has the ".gz" extension.
+**
+**  Sets the fail bit if the file cannot be opened, or if writing or
+**  closing the file fails.
+*/
+class CifOutFileStream : public std::ostream
+{
+  public:
+    CifOutFileStream(const std::string& fileName);
+    ~CifOutFileStream();
+
+    void Close();
+
+  private:
+    bool _compressed;
+
+    CifGzStreamBuf _gzStreamBuf;
+    std::filebuf _fileBuf;
+};
+
+
+#endif
@@ -0,0 +1,98 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifJoinIndex.h
+**
+** Multi-column hash index over category tables.
+*/
+
+
+#ifndef CIFJOININDEX_H
+#define CIFJOININDEX_H
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+
+#include "CifFile.h"
+
+
+/**
+**  \class CifJoinIndex
+**
+**  \brief Finds rows of category tables by the values of several
+**  attributes, as used when following references between categories.
+**
+**  An index on a set of attributes of a table is built the first time it
+**  is searched and is reused for all subsequent searches. The tables must
+**  not be modified while the join index is in use.
+*/
+class CifJoinIndex
+{
+  public:
+    /**
+    **  Makes a hash key from a tuple of values.
+    */
+    static void MakeKey(std::string& key,
+      const std::vector<std::string>& values);
+
+    /**
+    **  Makes a hash key from a tuple of values, normalized so that values
+    **  that are equal when compared case-insensitively, ignoring white
+    **  space, or as integers, have the same key.
+    */
+    static void MakeNormKey(std::string& key,
+      const std::vector<std::string>& values);
+
+    CifJoinIndex();
+    ~CifJoinIndex();
+
+    /**
+    **  Finds the first row of a table with the given attribute values.
+    **
+    **  \param[in] isTable - reference to the table to be searched
+    **  \param[in] values - the values of the attributes
+    **  \param[in] attribs - the attribute names
+    **
+    **  \return index of the first row that matches, or the number of rows
+    **    in the table if no row matches. The index answers only when the
+    **    first exact match is also the first row with the same normalized
+    **    values (see MakeNormKey()). Otherwise, an earlier row may match in
+    **    the comparison type of a column, and the search falls back to
+    **    ISTable::FindFirst(). The result is the same as that of
+    **    ISTable::FindFirst() for columns that compare exactly,
+    **    case-insensitively, ignoring white space, or as integers.
+    */
+    unsigned int FindFirst(ISTable& isTable,
+      const std::vector<std::string>& values,
+      const std::vector<std::string>& attribs);
+
+  private:
+    typedef std::unordered_map<std::string, unsigned int> RowIndex;
+
+    // First row of each value tuple, and of each normalized value tuple
+    struct TableIndex
+    {
+        RowIndex exactRows;
+        RowIndex normRows;
+    };
+
+    std::map<std::string, TableIndex*> _indices;
+
+    std::string _key;
+
+    TableIndex& GetIndex(ISTable& isTable,
+      const std::vector<std::string>& attribs);
+
+    CifJoinIndex(const CifJoinIndex&);
+    CifJoinIndex& operator=(const CifJoinIndex&);
+};
+
+
+#endif
@@ -0,0 +1,92 @@
+//$$FILE$$
+//$$VERSION$$
+//$$DATE$$
+//$$LICENSE$$
+
+
+/**
+** \file CifStreamCorrector.h
+**
+** Streaming CIF corrector class.
+*/
+
+
+#ifndef CIFSTREAMCORRECTOR_H
+#define CIFSTREAMCORRECTOR_H
+
+
+#include <string>
+#include <iostream>
+
+#include "DataInfo.h"
+#include "CifFile.h"
+#include "CifEnumIndex.h"
+
+
+/**
+**  \class CifStreamCorrector
+**
+**  \brief Corrects a CIF file one category at a time, with bounded memory.
+**
+**  The file is split into categories by CifCategoryScanner. Categories
+**  used by operations that involve more than one table are parsed and
+**  corrected together and kept in memory. All other categories are
+**  parsed, corrected and written one at a time, in file order. Peak
+**  memory is bounded by the largest category plus the kept categories,
+**  instead of by the whole file. The output is identical to that of
+**  correcting the whole file with CifCorrector.
+**
+**  A gzip compressed file is first decompressed into a temporary file next
+**  to the output file, which is then streamed.
+**
+**  Files with more than one data block, with categories split over more
+**  than one place, or with syntax that cannot be split at line boundaries
+**  are corrected in memory.
+**
+**  The CIF parser can parse only one file at a time in a process, so
+**  correctors must not run on more than one thread at the same time.
+*/
+class CifStreamCorrector
+{
+  public:
+    CifStreamCorrector(DataInfo& dataInfo, DataInfo& pdbxDataInfo,
+      CifFile& configFile, CifEnumIndex& enumIndex,
+      const bool verbose = false);
+    ~CifStreamCorrector();
+
+    void Correct(const std::string& inFileName,
+      const std::string& outFileName);
+
+    /**
+    **  Returns true if the last corrected file has been streamed, false if
+    **  it has been corrected in memory.
+    */
+    bool IsStreamed() const;
+
+    /**
+    **  Returns true if correcting the last file has changed it.
+    */
+    bool IsChanged() const;
+
+  private:
+    DataInfo& _dataInfo;
+    DataInfo& _pdbxDataInfo;
+
+    CifFile& _configFile;
+    CifEnumIndex& _enumIndex;
+
+    bool _verbose;
+    bool _streamed;
+    bool _changed;
+
+    void CorrectPlain(const std::string& inFileName,
+      const std::string& outFileName);
+    void CorrectInMemory(const std::string& inFileName,
+      const std::string& outFileName);
+    void CorrectFile(CifFile& cifFile);
+
+    CifFile* ParseText(const std::string& cifText);
+};
+
+
+#endif